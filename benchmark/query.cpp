@@ -5,9 +5,32 @@
 
 using namespace std;
 
+#ifdef QUERY_STATS
+/**
+ * Prints a histogram of values with power-of-two buckets:
+ * 0, 1, 2-3, 4-7, ...
+ */
+void print_histogram(const string& name, const vector <long long>& values) {
+    vector <long long> buckets;
+    for (long long value : values) {
+        unsigned int bucket = 0;
+        while ((1LL << bucket) <= value) bucket++;
+        if (bucket >= buckets.size()) buckets.resize(bucket + 1, 0);
+        buckets [bucket] ++;
+    }
+    cout << name << ":";
+    for (unsigned int i = 0; i < buckets.size(); i++) {
+        if (i == 0) cout << " [0]=";
+        else cout << " [" << (1LL << (i - 1)) << '-' << (1LL << i) - 1 << "]=";
+        cout << buckets [i];
+    }
+    cout << endl;
+}
+#endif
+
 int main (const int argc, const char* argv[]) {
     if (argc < 5) {
-        cerr << "Usage " << argv[0] << " <reads_fasta_file> <max_read_length> <query_legth> <query_count> <query_file>\n";
+        cerr << "Usage " << argv[0] << " <reads_fasta_file> <query_legth> <query_count> <query_file> [metrics_prefix]\n";
         exit(1);
     }
 
@@ -19,12 +42,17 @@ int main (const int argc, const char* argv[]) {
     }
     
     string reads_fasta_file = argv[1];
-    int rlen = stoi(argv[2]);
-    int qlen = stoi(argv[3]);
-    int qcount = stoi(argv[4]);
-    string query_file = argv[5];
-    SR_index index(qlen, rlen);
+    int qlen = stoi(argv[2]);
+    int qcount = stoi(argv[3]);
+    string query_file = argv[4];
+    SR_index index(qlen);
     index.construct(reads_fasta_file);
+    if (argc > 5) {
+        ofstream metrics_out(string(argv[5]) + ".metrics.json");
+        index.write_metrics(metrics_out);
+        ofstream structure_out(string(argv[5]) + ".structure.json");
+        index.write_structure(structure_out);
+    }
     
     vector <string> queries(qcount);
     ifstream query_in(query_file, ifstream::in);
@@ -42,4 +70,59 @@ int main (const int argc, const char* argv[]) {
     tend = chrono::system_clock::now();
     elapsed = tend - tbegin;
     cout << "Querying took " << elapsed.count() << "s\n";
+
+    double serial_seconds = elapsed.count();
+    tbegin = chrono::system_clock::now();
+    index.find_reads_batch(queries);
+    tend = chrono::system_clock::now();
+    elapsed = tend - tbegin;
+    cout << "Batched querying took " << elapsed.count() << "s, speedup over serial " << serial_seconds / elapsed.count() << "\n";
+
+#ifdef QUERY_STATS
+    vector <long long> occurrences_examined, rejected_by_counts, binary_search_probes, candidates_scanned, rank_calls;
+    for (int i = 0; i < qcount; i++) {
+        QueryStats stats;
+        index.find_reads(queries [i], false, &stats);
+        occurrences_examined.push_back(stats.occurrences_examined);
+        rejected_by_counts.push_back(stats.rejected_by_counts);
+        binary_search_probes.push_back(stats.binary_search_probes);
+        candidates_scanned.push_back(stats.candidates_scanned);
+        rank_calls.push_back(stats.rank_calls);
+    }
+    print_histogram("occurrences examined", occurrences_examined);
+    print_histogram("rejected by counts", rejected_by_counts);
+    print_histogram("binary search probes", binary_search_probes);
+    print_histogram("candidates scanned", candidates_scanned);
+    print_histogram("rank calls", rank_calls);
+#endif
+
+    for (int mismatches = 1; mismatches <= 2; mismatches++) {
+        tbegin = chrono::system_clock::now();
+        for (int i = 0; i < qcount; i++) {
+            index.find_reads_approx(queries [i], mismatches);
+        }
+        tend = chrono::system_clock::now();
+        elapsed = tend - tbegin;
+        cout << "Querying with " << mismatches << " mismatches took " << elapsed.count() << "s\n";
+    }
+
+    // Baseline for bulk reporting: one find_reads of the k-mer starting at each position
+    long long positions = min((long long) qcount, index.superstring_length() - qlen + 1);
+    vector <string> position_kmers;
+    for (long long position = 0; position < positions; position++) {
+        position_kmers.push_back(index.superstring(position, position + qlen - 1));
+    }
+    tbegin = chrono::system_clock::now();
+    for (auto& kmer : position_kmers) {
+        index.find_reads(kmer, false);
+    }
+    tend = chrono::system_clock::now();
+    elapsed = tend - tbegin;
+    cout << "Per-position find_reads for " << positions << " positions took " << elapsed.count() << "s (" << positions / elapsed.count() << " positions/s)\n";
+
+    tbegin = chrono::system_clock::now();
+    index.find_reads_in_interval(0, positions - 1);
+    tend = chrono::system_clock::now();
+    elapsed = tend - tbegin;
+    cout << "Bulk reporting for " << positions << " positions took " << elapsed.count() << "s (" << positions / elapsed.count() << " positions/s)\n";
 }
@@ -0,0 +1,28 @@
+#include "simulator.h"
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+int main (const int argc, const char* argv[]) {
+    if (argc < 5) {
+        cerr << "Usage " << argv[0] << " <reads_fasta_file> <query_file> <query_length> <query_count> [genome_size] [read_length] [coverage] [error_rate] [repeat_fraction] [seed]\n";
+        exit(1);
+    }
+
+    SimulationParams params;
+    if (argc > 5) params.genome_size = stoll(argv[5]);
+    if (argc > 6) params.read_length = stoi(argv[6]);
+    if (argc > 7) params.coverage = stod(argv[7]);
+    if (argc > 8) params.error_rate = stod(argv[8]);
+    if (argc > 9) params.repeat_fraction = stod(argv[9]);
+    if (argc > 10) params.seed = stoull(argv[10]);
+
+    ReadSimulator simulator(params);
+    simulator.write_fasta(simulator.reads(), argv[1]);
+    ofstream query_out(argv[2], ofstream::out);
+    for (auto& query : simulator.queries(stoi(argv[4]), stoi(argv[3]))) {
+        query_out << query << '\n';
+    }
+    query_out.close();
+}
@@ -0,0 +1,77 @@
+#include "simulator.h"
+#include <fstream>
+
+using namespace std;
+
+ReadSimulator::ReadSimulator(const SimulationParams& p): params(p), rng(p.seed) {
+    vector <string> repeats(params.repeat_elements);
+    for (auto& repeat : repeats) {
+        for (int i = 0; i < params.repeat_length; i++) repeat.push_back(random_base());
+    }
+
+    // Alternate unique and repeat chunks of repeat_length bases
+    while ((long long) genome.size() < params.genome_size) {
+        if (!repeats.empty() && probability() < params.repeat_fraction) {
+            genome += repeats [uniform(repeats.size())];
+        }
+        else {
+            for (int i = 0; i < params.repeat_length; i++) genome.push_back(random_base());
+        }
+    }
+    genome.resize(params.genome_size);
+}
+
+// Avoids std distributions, whose output differs between standard libraries.
+unsigned long long ReadSimulator::uniform(unsigned long long n) {
+    return rng() % n;
+}
+
+double ReadSimulator::probability() {
+    return (rng() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+char ReadSimulator::random_base() {
+    return "ACGT" [uniform(4)];
+}
+
+const string& ReadSimulator::get_genome() {
+    return genome;
+}
+
+vector <string> ReadSimulator::reads() {
+    long long count = params.coverage * params.genome_size / params.read_length;
+    vector <string> result;
+    for (long long i = 0; i < count; i++) {
+        long long length = params.read_length - params.read_length_jitter + uniform(2 * params.read_length_jitter + 1);
+        length = min(length, (long long) genome.size());
+        string read = genome.substr(uniform(genome.size() - length + 1), length);
+        for (auto& base : read) {
+            if (probability() < params.error_rate) {
+                char substituted = base;
+                while (substituted == base) substituted = random_base();
+                base = substituted;
+            }
+        }
+        result.push_back(read);
+    }
+    return result;
+}
+
+/**
+ * Error-free substrings of the genome of given length.
+ */
+vector <string> ReadSimulator::queries(int count, int length) {
+    vector <string> result;
+    for (int i = 0; i < count; i++) {
+        result.push_back(genome.substr(uniform(genome.size() - length + 1), length));
+    }
+    return result;
+}
+
+void ReadSimulator::write_fasta(const vector <string>& reads, const string& fasta_file) {
+    ofstream file_out(fasta_file, ofstream::out);
+    for (unsigned int i = 0; i < reads.size(); i++) {
+        file_out << ">read" << i << '\n' << reads [i] << '\n';
+    }
+    file_out.close();
+}
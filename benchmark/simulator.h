@@ -0,0 +1,44 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct SimulationParams {
+    long long genome_size = 100000;
+    int read_length = 100;
+    // Read lengths are drawn uniformly from read_length +- read_length_jitter
+    int read_length_jitter = 0;
+    double coverage = 10;
+    // Probability of substituting each base of a read
+    double error_rate = 0;
+    // Fraction of the genome made of copies of repeat elements
+    double repeat_fraction = 0;
+    int repeat_length = 300;
+    int repeat_elements = 10;
+    unsigned long long seed = 42;
+};
+
+/**
+ * Deterministic genome and read simulator. The same parameters always
+ * give the same genome, reads and queries on every platform.
+ */
+class ReadSimulator {
+    SimulationParams params;
+    mt19937_64 rng;
+    string genome;
+    unsigned long long uniform(unsigned long long);
+    double probability();
+    char random_base();
+    public:
+        ReadSimulator(const SimulationParams&);
+        const string& get_genome();
+        vector <string> reads();
+        vector <string> queries(int, int);
+        void write_fasta(const vector <string>&, const string&);
+};
+
+#endif //SIMULATOR_H
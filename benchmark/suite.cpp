@@ -0,0 +1,124 @@
+#include "../sr-index.hpp"
+#include "simulator.h"
+#include <vector>
+#include <fstream>
+#include <sys/resource.h>
+
+using namespace std;
+
+double percentile(vector <double>& sorted, double p) {
+    return sorted [min(sorted.size() - 1, (size_t) (p * sorted.size()))];
+}
+
+int main (const int argc, const char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--help") {
+        cerr << "Usage " << argv[0] << " [label] [k] [genome_size] [read_length] [coverage] [error_rate] [repeat_fraction] [query_count] [seed]\n";
+        exit(1);
+    }
+
+    struct rlimit stack_limit;
+    getrlimit(RLIMIT_STACK, &stack_limit);
+    stack_limit.rlim_cur = RLIM_INFINITY;
+    if (setrlimit(RLIMIT_STACK, &stack_limit) != 0) {
+        cerr << "Unlimiting stack size failed, might crash.\n";
+    }
+
+    string label = argc > 1 ? argv[1] : "default";
+    int k = argc > 2 ? stoi(argv[2]) : 31;
+    SimulationParams params;
+    if (argc > 3) params.genome_size = stoll(argv[3]);
+    if (argc > 4) params.read_length = stoi(argv[4]);
+    if (argc > 5) params.coverage = stod(argv[5]);
+    if (argc > 6) params.error_rate = stod(argv[6]);
+    if (argc > 7) params.repeat_fraction = stod(argv[7]);
+    int qcount = argc > 8 ? stoi(argv[8]) : 10000;
+    if (argc > 9) params.seed = stoull(argv[9]);
+
+    ReadSimulator simulator(params);
+    boost::filesystem::path fasta_file = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("sr-index-%%%%%%%%.fa");
+    simulator.write_fasta(simulator.reads(), fasta_file.string());
+    vector <string> queries = simulator.queries(qcount, k);
+
+    chrono::time_point<chrono::steady_clock> tbegin, tend;
+    chrono::duration<double> elapsed;
+    SR_index index(k);
+    tbegin = chrono::steady_clock::now();
+    index.construct(fasta_file.string());
+    tend = chrono::steady_clock::now();
+    elapsed = tend - tbegin;
+    boost::filesystem::remove(fasta_file);
+
+    cout << "label,metric,value\n";
+    cout << label << ",build.seconds," << elapsed.count() << '\n';
+    index.write_metrics_csv(cout, label);
+
+    // Single-query latency distribution
+    vector <double> latencies;
+    long long hits = 0;
+    for (auto& query : queries) {
+        tbegin = chrono::steady_clock::now();
+        hits += index.find_reads(query, false).size();
+        tend = chrono::steady_clock::now();
+        latencies.push_back(chrono::duration<double, micro>(tend - tbegin).count());
+    }
+    sort(latencies.begin(), latencies.end());
+    double total = 0;
+    for (double latency : latencies) total += latency;
+    cout << label << ",query.hits," << hits << '\n';
+    cout << label << ",query.latency_us.mean," << total / latencies.size() << '\n';
+    cout << label << ",query.latency_us.p50," << percentile(latencies, 0.5) << '\n';
+    cout << label << ",query.latency_us.p90," << percentile(latencies, 0.9) << '\n';
+    cout << label << ",query.latency_us.p99," << percentile(latencies, 0.99) << '\n';
+    cout << label << ",query.latency_us.max," << latencies.back() << '\n';
+
+    // Batch throughput
+    tbegin = chrono::steady_clock::now();
+    for (auto& query : queries) {
+        index.find_reads(query, false);
+    }
+    tend = chrono::steady_clock::now();
+    elapsed = tend - tbegin;
+    cout << label << ",batch.queries_per_second," << queries.size() / elapsed.count() << '\n';
+    double serial_seconds = elapsed.count();
+
+    tbegin = chrono::steady_clock::now();
+    index.find_reads_batch(queries);
+    tend = chrono::steady_clock::now();
+    elapsed = tend - tbegin;
+    cout << label << ",batch.interleaved.queries_per_second," << queries.size() / elapsed.count() << '\n';
+    cout << label << ",batch.interleaved.speedup," << serial_seconds / elapsed.count() << '\n';
+
+    for (int mismatches = 1; mismatches <= 2; mismatches++) {
+        tbegin = chrono::steady_clock::now();
+        for (auto& query : queries) {
+            index.find_reads_approx(query, mismatches);
+        }
+        tend = chrono::steady_clock::now();
+        elapsed = tend - tbegin;
+        cout << label << ",batch.approx" << mismatches << ".queries_per_second," << queries.size() / elapsed.count() << '\n';
+    }
+
+    tbegin = chrono::steady_clock::now();
+    index.find_reads_in_interval(0, index.superstring_length() - 1);
+    tend = chrono::steady_clock::now();
+    elapsed = tend - tbegin;
+    cout << label << ",bulk.positions_per_second," << index.superstring_length() / elapsed.count() << '\n';
+
+    // Skewed workload, every other query is one of 100 hot patterns
+    vector <string> skewed;
+    for (unsigned int i = 0; i < queries.size(); i++) {
+        skewed.push_back(queries [i % 2 == 0 ? (i / 2) % 100 : i]);
+    }
+    index.enable_cache(64 << 20);
+    tbegin = chrono::steady_clock::now();
+    for (auto& query : skewed) {
+        index.find_reads(query, false);
+    }
+    tend = chrono::steady_clock::now();
+    elapsed = tend - tbegin;
+    cout << label << ",cache.skewed.queries_per_second," << skewed.size() / elapsed.count() << '\n';
+    index.get_cache() -> write_csv(cout, label, "cache");
+    index.disable_cache();
+
+    cout << label << ",memory.peak_rss_kb," << Metrics::peak_rss_kb() << '\n';
+}
@@ -2,6 +2,7 @@
 #include <vector>
 #include <unistd.h>
 #include <fstream>
+#include <sstream>
 #include <sys/resource.h>
 
 
@@ -20,23 +21,20 @@ int main (const int argc, char* argv[]) {
     }
     int k = atol(argv [1]);
     boost::filesystem::path orig_file = boost::filesystem::path(argv [2]);
-    ifstream file_in(orig_file.string(), ifstream::in);
-    string seq;
-    file_in >> seq; file_in >> seq;
-    file_in.close();
-    
-    SR_index index(k, seq.size());
+    SR_index index(k);
     index.construct(orig_file.string());
     index.print_superstring();
-    string query;
+    string query, seq;
 
-    file_in.open(orig_file.string(), ifstream::in);
+    ifstream file_in(orig_file.string(), ifstream::in);
+    vector <string> queries;
     int counter = 0;
     while (file_in >> seq) {
         file_in >> seq;
         bool ok = false;
         string q = seq.substr(rand()%(seq.size() - k + 1), k);
         vector <int> results = index.find_reads(q, false);
+        queries.push_back(q);
         for (auto x : results) {
             if (x == counter) {
                 ok = true;
@@ -47,8 +45,77 @@ int main (const int argc, char* argv[]) {
             cerr << "String not found where expected!\n";
             cerr << q << ' ' << counter << endl;
         }
+
+        if (index.find_reads_approx(q, 0) != results) {
+            cerr << "Approximate search with 0 mismatches differs from exact!\n";
+            cerr << q << ' ' << counter << endl;
+        }
+        string mutated = q;
+        int mutated_position = rand() % k;
+        while (mutated [mutated_position] == q [mutated_position]) mutated [mutated_position] = "ACGT" [rand() % 4];
+        vector <int> approx_results = index.find_reads_approx(mutated, 1);
+        if (find(approx_results.begin(), approx_results.end(), counter) == approx_results.end()) {
+            cerr << "String with 1 mismatch not found where expected!\n";
+            cerr << mutated << ' ' << counter << endl;
+        }
         counter++;
     } 
+
+    vector <vector <int> > expected;
+    for (auto& q : queries) {
+        expected.push_back(index.find_reads(q, false));
+    }
+
+    vector <vector <int> > batch_results = index.find_reads_batch(queries);
+    for (unsigned int i = 0; i < queries.size(); i++) {
+        if (batch_results [i] != expected [i]) {
+            cerr << "Batched search differs from find_reads!\n";
+            cerr << queries [i] << ' ' << i << endl;
+        }
+    }
+
+    vector <vector <int> > interval_results = index.find_reads_in_interval(0, index.superstring_length() - 1);
+    for (long long position = 0; position < index.superstring_length(); position++) {
+        if (interval_results [position] != index.find_reads_at(position)) {
+            cerr << "Interval search differs from single position search!\n";
+            cerr << position << endl;
+        }
+    }
+
+    // Second round is served from the cache
+    index.enable_cache(1 << 20);
+    for (int round = 0; round < 2; round++) {
+        for (unsigned int i = 0; i < queries.size(); i++) {
+            if (index.find_reads(queries [i], false) != expected [i]) {
+                cerr << "Search with cache differs from search without it!\n";
+                cerr << queries [i] << ' ' << i << endl;
+            }
+        }
+    }
+    index.disable_cache();
+
+    // An exact lookup must not change a later cached approximate result
+    string prefix = queries [0].substr(0, k - 2);
+    vector <int> approx_expected = index.find_reads_approx(prefix, 1);
+    index.enable_cache(1 << 20);
+    index.find_reads(prefix + "/1", false);
+    index.find_reads(prefix, false);
+    if (index.find_reads_approx(prefix, 1) != approx_expected) {
+        cerr << "Cached approximate search differs after exact search!\n";
+        cerr << prefix << endl;
+    }
+    index.disable_cache();
+
+    stringstream stored;
+    index.serialize(stored);
+    SR_index loaded(k);
+    loaded.load(stored);
+    for (unsigned int i = 0; i < queries.size(); i++) {
+        if (loaded.find_reads(queries [i], false) != expected [i]) {
+            cerr << "Search differs after serialize and load!\n";
+            cerr << queries [i] << ' ' << i << endl;
+        }
+    }
     cerr << "finish" << endl;
     while (cin >> query) {
         for (auto x : index.find_reads(query, false)) {
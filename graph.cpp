@@ -65,6 +65,7 @@ void Graph::add_edge(int_t from, int_t to, vector <map <int_t, int> >& edges, ma
 void Graph::load_edges(const string& fasta_file) {
     vector <map <int_t, int> > edges;
     map <int_t, int_t> label_compress;
+    metrics.start_stage("load_edges");
     cerr << "opening " + fasta_file << endl;
     ifstream file_in(fasta_file, ifstream::in);
     string seq;
@@ -92,6 +93,10 @@ void Graph::load_edges(const string& fasta_file) {
     }
     edges_for_euler.shrink_to_fit();
     cerr << "Total number of edges: " << this->primitive_edges << endl;
+    metrics.finish_stage();
+    metrics.set_count("reads", n);
+    metrics.set_count("vertices", number_of_vertices);
+    metrics.set_count("primitive_edges", primitive_edges);
 }
 
 /**
@@ -153,6 +158,7 @@ void Graph::remove_edge(int from, long long edge_number) {
 }
 
 void Graph::adjoin_edges(const string& fasta_file) {
+    metrics.start_stage("adjoin_edges");
     cerr << "adjoining edges\n";
     vector <vector <long long> > reverse_edges(this -> number_of_vertices);
     for (int i = 0; i < this -> number_of_vertices; i++) {
@@ -290,7 +296,8 @@ void Graph::adjoin_edges(const string& fasta_file) {
             composite_edges ++;
         }
     }
-    
+    metrics.finish_stage();
+    metrics.set_count("composite_edges", composite_edges - 1);
 }
 
 /**
@@ -395,6 +402,7 @@ void Graph::connect_components() {
         }
     }
     cerr << "Connected " << total_connections + 1 << "components\n";
+    metrics.set_count("components_joined", total_connections + 1);
 }
 
 void Graph::construct_edges_for_euler() {
@@ -426,6 +434,7 @@ void Graph::construct_edges_for_euler() {
     }
     
     cerr << "assignment problem size: " << bad_vertices.size() << endl;
+    metrics.set_count("assignment_problem_size", bad_vertices.size());
     // Add edges so that the graph is eulerian.
     this->random_assignment(bad_vertices);
     // Connect all the components (in unoriented sense)
@@ -458,7 +467,9 @@ vector <long long> Graph::list_edges(long long edge) {
 }
 
 vector <int_t> Graph::euler_path() {
+    metrics.start_stage("make_eulerian");
     this -> construct_edges_for_euler();
+    metrics.start_stage("euler_path");
 
     cerr << "begin recursive euler" << endl;
 
@@ -477,6 +488,12 @@ vector <int_t> Graph::euler_path() {
     }
     decompressed_result.shrink_to_fit();
     cerr << "finish\n";
+    metrics.finish_stage();
+    metrics.set_count("eulerian_primitive_edges", primitive_edges);
+    metrics.set_count("path_vertices", decompressed_result.size());
     return decompressed_result;
 }
 
+const Metrics& Graph::get_metrics() {
+    return metrics;
+}
@@ -5,6 +5,7 @@
 #include <map>
 #include <set>
 #include "common.h"
+#include "metrics.h"
 
 using namespace std;
 
@@ -22,6 +23,7 @@ class Graph {
     long long primitive_edges = 0;
     int k;
     int nonempty_vertex = -1;
+    Metrics metrics;
     void connect_components();
     void construct_edges_for_euler();
     void random_assignment(vector <pair <int_t, bool> >&);
@@ -39,6 +41,7 @@ class Graph {
         vector <int> path_counts();
         void load_edges(const string&);
         void adjoin_edges(const string&);
+        const Metrics& get_metrics();
 };
 
 #endif //GRAPH_H
@@ -0,0 +1,79 @@
+#include "metrics.h"
+#include <sys/resource.h>
+
+using namespace std;
+
+long Metrics::peak_rss_kb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+void Metrics::start_stage(const string& name) {
+    if (!current_stage.empty()) finish_stage();
+    current_stage = name;
+    stage_begin = chrono::steady_clock::now();
+}
+
+void Metrics::finish_stage() {
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - stage_begin;
+    stages.push_back(Stage{current_stage, elapsed.count(), peak_rss_kb()});
+    current_stage.clear();
+}
+
+/**
+ * Overwrites the value under name, or appends it, so that values
+ * keep the order in which they were first recorded.
+ */
+void Metrics::set(vector <pair <string, long long> >& values, const string& name, long long value) {
+    for (auto& v : values) {
+        if (v.first == name) {
+            v.second = value;
+            return;
+        }
+    }
+    values.push_back(make_pair(name, value));
+}
+
+void Metrics::set_count(const string& name, long long value) {
+    set(counts, name, value);
+}
+
+void Metrics::set_bytes(const string& name, long long value) {
+    set(bytes, name, value);
+}
+
+void Metrics::write_json(ostream& out) const {
+    out << "{\"stages\": [";
+    for (unsigned int i = 0; i < stages.size(); i++) {
+        if (i > 0) out << ", ";
+        out << "{\"name\": \"" << stages [i].name << "\", \"seconds\": " << stages [i].seconds << ", \"peak_rss_kb\": " << stages [i].peak_rss_kb << "}";
+    }
+    out << "], \"counts\": {";
+    for (unsigned int i = 0; i < counts.size(); i++) {
+        if (i > 0) out << ", ";
+        out << "\"" << counts [i].first << "\": " << counts [i].second;
+    }
+    out << "}, \"bytes\": {";
+    for (unsigned int i = 0; i < bytes.size(); i++) {
+        if (i > 0) out << ", ";
+        out << "\"" << bytes [i].first << "\": " << bytes [i].second;
+    }
+    out << "}, \"peak_rss_kb\": " << peak_rss_kb() << "}";
+}
+
+/**
+ * Writes one "label,metric,value" row per value, metric names prefixed by prefix.
+ */
+void Metrics::write_csv(ostream& out, const string& label, const string& prefix) const {
+    for (auto& stage : stages) {
+        out << label << ',' << prefix << ".seconds." << stage.name << ',' << stage.seconds << '\n';
+        out << label << ',' << prefix << ".peak_rss_kb." << stage.name << ',' << stage.peak_rss_kb << '\n';
+    }
+    for (auto& count : counts) {
+        out << label << ',' << prefix << ".count." << count.first << ',' << count.second << '\n';
+    }
+    for (auto& size : bytes) {
+        out << label << ',' << prefix << ".bytes." << size.first << ',' << size.second << '\n';
+    }
+}
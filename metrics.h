@@ -0,0 +1,37 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Per-stage timings and peak RSS, item counts and byte sizes
+ * collected during a build, written out as JSON.
+ */
+class Metrics {
+    struct Stage {
+        string name;
+        double seconds;
+        long peak_rss_kb;
+    };
+    vector <Stage> stages;
+    vector <pair <string, long long> > counts;
+    vector <pair <string, long long> > bytes;
+    string current_stage;
+    chrono::time_point<chrono::steady_clock> stage_begin;
+    void set(vector <pair <string, long long> >&, const string&, long long);
+    public:
+        void start_stage(const string&);
+        void finish_stage();
+        void set_count(const string&, long long);
+        void set_bytes(const string&, long long);
+        void write_json(ostream&) const;
+        void write_csv(ostream&, const string&, const string&) const;
+        static long peak_rss_kb();
+};
+
+#endif //METRICS_H
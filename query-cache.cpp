@@ -0,0 +1,105 @@
+#include "query-cache.hpp"
+
+using namespace std;
+
+// Approximate bookkeeping cost of an entry besides its key and value
+#define ENTRY_OVERHEAD 96
+
+size_t QueryCache::entry_bytes(const Entry& entry) {
+    return entry.key.size() + entry.encoded.size() + ENTRY_OVERHEAD;
+}
+
+/**
+ * Encodes sorted read ids as gaps, 7 bits per byte,
+ * highest bit set on all but the last byte of a gap.
+ */
+string QueryCache::encode(const vector <int>& reads) {
+    string result;
+    unsigned int last = 0;
+    for (int read : reads) {
+        unsigned int gap = read - last;
+        last = read;
+        while (gap >= 128) {
+            result.push_back((char) ((gap & 127) | 128));
+            gap >>= 7;
+        }
+        result.push_back((char) gap);
+    }
+    return result;
+}
+
+vector <int> QueryCache::decode(const string& encoded) {
+    vector <int> result;
+    unsigned int last = 0, gap = 0, shift = 0;
+    for (char c : encoded) {
+        unsigned char byte = c;
+        gap |= (unsigned int) (byte & 127) << shift;
+        shift += 7;
+        if (byte < 128) {
+            last += gap;
+            result.push_back(last);
+            gap = 0;
+            shift = 0;
+        }
+    }
+    return result;
+}
+
+bool QueryCache::lookup(const string& key, vector <int>& result) {
+    lock_guard <mutex> guard(lock);
+    auto entry = entries.find(key);
+    if (entry == entries.end()) {
+        misses ++;
+        return false;
+    }
+    hits ++;
+    lru.splice(lru.begin(), lru, entry -> second);
+    result = decode(entry -> second -> encoded);
+    return true;
+}
+
+void QueryCache::insert(const string& key, const vector <int>& reads) {
+    Entry entry{key, encode(reads)};
+    if (entry_bytes(entry) > max_bytes) return;
+    lock_guard <mutex> guard(lock);
+    if (entries.count(key) > 0) return;
+    lru.push_front(entry);
+    entries [key] = lru.begin();
+    used_bytes += entry_bytes(entry);
+    while (used_bytes > max_bytes) {
+        used_bytes -= entry_bytes(lru.back());
+        entries.erase(lru.back().key);
+        lru.pop_back();
+        evictions ++;
+    }
+}
+
+/**
+ * Drops all entries, statistics are kept.
+ */
+void QueryCache::clear() {
+    lock_guard <mutex> guard(lock);
+    lru.clear();
+    entries.clear();
+    used_bytes = 0;
+}
+
+void QueryCache::write_stats(ostream& out) const {
+    lock_guard <mutex> guard(lock);
+    double hit_rate = hits + misses > 0 ? (double) hits / (hits + misses) : 0;
+    out << "{\"hits\": " << hits << ", \"misses\": " << misses << ", \"hit_rate\": " << hit_rate << ", \"evictions\": " << evictions << ", \"entries\": " << entries.size() << ", \"bytes\": " << used_bytes << ", \"max_bytes\": " << max_bytes << "}";
+}
+
+/**
+ * Writes one "label,metric,value" row per statistic, metric names prefixed by prefix.
+ */
+void QueryCache::write_csv(ostream& out, const string& label, const string& prefix) const {
+    lock_guard <mutex> guard(lock);
+    double hit_rate = hits + misses > 0 ? (double) hits / (hits + misses) : 0;
+    out << label << ',' << prefix << ".hits," << hits << '\n';
+    out << label << ',' << prefix << ".misses," << misses << '\n';
+    out << label << ',' << prefix << ".hit_rate," << hit_rate << '\n';
+    out << label << ',' << prefix << ".evictions," << evictions << '\n';
+    out << label << ',' << prefix << ".entries," << entries.size() << '\n';
+    out << label << ',' << prefix << ".bytes," << used_bytes << '\n';
+}
@@ -0,0 +1,39 @@
+#ifndef QUERY_CACHE__
+#define QUERY_CACHE__
+
+#include <list>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Bounded LRU cache of query results, safe to share between threads.
+ * Read ids are stored delta and varint encoded.
+ */
+class QueryCache {
+    struct Entry {
+        string key;
+        string encoded;
+    };
+    list <Entry> lru;
+    unordered_map <string, list <Entry>::iterator> entries;
+    size_t max_bytes, used_bytes = 0;
+    long long hits = 0, misses = 0, evictions = 0;
+    mutable mutex lock;
+    static size_t entry_bytes(const Entry&);
+    static string encode(const vector <int>&);
+    static vector <int> decode(const string&);
+    public:
+        QueryCache(size_t max): max_bytes(max){}
+        bool lookup(const string&, vector <int>&);
+        void insert(const string&, const vector <int>&);
+        void clear();
+        void write_stats(ostream&) const;
+        void write_csv(ostream&, const string&, const string&) const;
+};
+
+#endif //QUERY_CACHE__
@@ -0,0 +1,25 @@
+#include "../sr-index.hpp"
+#include <sys/resource.h>
+
+using namespace std;
+
+int main (const int argc, const char* argv[]) {
+    if (argc < 4) {
+        cerr << "Usage " << argv[0] << " <k> <reads_fasta_file> <index_file>\n";
+        exit(1);
+    }
+
+    struct rlimit stack_limit;
+    getrlimit(RLIMIT_STACK, &stack_limit);
+    stack_limit.rlim_cur = RLIM_INFINITY;
+    if (setrlimit(RLIMIT_STACK, &stack_limit) != 0) {
+        cerr << "Unlimiting stack size failed, might crash.\n";
+    }
+
+    SR_index index(stoi(argv[1]));
+    index.construct(argv[2]);
+    ofstream index_out(argv[3], ofstream::binary);
+    index.serialize(index_out);
+    index_out.close();
+    cerr << "Index written to " << argv[3] << endl;
+}
@@ -0,0 +1,122 @@
+#include "protocol.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+/**
+ * Sends batches of one connection, keeping up to depth of them in flight,
+ * and records the latency of every batch in microseconds. Responses are
+ * read on a separate thread, so sending never waits for them to be read.
+ */
+void run_connection(const string& socket_path, const vector <string>& queries, int batch_size, int depth, int batches, vector <double>& latencies, long long& results) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr*) &address, sizeof(address)) < 0) {
+        perror("Connecting failed");
+        exit(1);
+    }
+
+    // Send times of the batches in flight
+    deque <chrono::time_point<chrono::steady_clock> > sent;
+    mutex lock;
+    condition_variable window;
+
+    thread reader([&] {
+        vector <vector <int> > batch_results;
+        for (int received_batches = 0; received_batches < batches; received_batches++) {
+            if (!read_results(fd, batch_results)) {
+                cerr << "Receiving results failed\n";
+                exit(1);
+            }
+            chrono::time_point<chrono::steady_clock> now = chrono::steady_clock::now();
+            {
+                lock_guard <mutex> guard(lock);
+                latencies.push_back(chrono::duration<double, micro>(now - sent.front()).count());
+                sent.pop_front();
+            }
+            window.notify_one();
+            for (auto& reads : batch_results) results += reads.size();
+        }
+    });
+
+    size_t next_query = 0;
+    for (int sent_batches = 0; sent_batches < batches; sent_batches++) {
+        vector <string> batch;
+        for (int i = 0; i < batch_size; i++) {
+            batch.push_back(queries [next_query]);
+            next_query = (next_query + 1) % queries.size();
+        }
+        {
+            unique_lock <mutex> guard(lock);
+            window.wait(guard, [&] {return (int) sent.size() < depth;});
+            sent.push_back(chrono::steady_clock::now());
+        }
+        if (!write_batch(fd, batch)) {
+            cerr << "Sending batch failed\n";
+            exit(1);
+        }
+    }
+    reader.join();
+    close(fd);
+}
+
+double percentile(vector <double>& sorted, double p) {
+    return sorted [min(sorted.size() - 1, (size_t) (p * sorted.size()))];
+}
+
+int main (const int argc, const char* argv[]) {
+    if (argc < 3) {
+        cerr << "Usage " << argv[0] << " <socket_path> <query_file> [connections] [batch_size] [pipeline_depth] [batches_per_connection]\n";
+        exit(1);
+    }
+    string socket_path = argv[1];
+    int connections = argc > 3 ? stoi(argv[3]) : 4;
+    int batch_size = argc > 4 ? stoi(argv[4]) : 1000;
+    int depth = argc > 5 ? stoi(argv[5]) : 4;
+    int batches = argc > 6 ? stoi(argv[6]) : 100;
+
+    vector <string> queries;
+    ifstream query_in(argv[2], ifstream::in);
+    string query;
+    while (query_in >> query) queries.push_back(query);
+    if (queries.empty()) {
+        cerr << "No queries in " << argv[2] << endl;
+        exit(1);
+    }
+
+    vector <vector <double> > latencies(connections);
+    vector <long long> results(connections, 0);
+    vector <thread> threads;
+    chrono::time_point<chrono::steady_clock> tbegin = chrono::steady_clock::now();
+    for (int i = 0; i < connections; i++) {
+        threads.push_back(thread(run_connection, socket_path, cref(queries), batch_size, depth, batches, ref(latencies [i]), ref(results [i])));
+    }
+    for (auto& t : threads) t.join();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - tbegin;
+
+    vector <double> all;
+    long long total_results = 0;
+    for (int i = 0; i < connections; i++) {
+        all.insert(all.end(), latencies [i].begin(), latencies [i].end());
+        total_results += results [i];
+    }
+    sort(all.begin(), all.end());
+    long long patterns = (long long) connections * batches * batch_size;
+    cout << "Patterns: " << patterns << ", read ids returned: " << total_results << endl;
+    cout << "Throughput: " << patterns / elapsed.count() << " patterns/s\n";
+    cout << "Batch latency us: p50 " << percentile(all, 0.5) << " p99 " << percentile(all, 0.99) << " p99.9 " << percentile(all, 0.999) << " max " << all.back() << endl;
+}
@@ -0,0 +1,85 @@
+#include "protocol.h"
+#include <cerrno>
+#include <iostream>
+#include <unistd.h>
+
+using namespace std;
+
+bool read_full(int fd, void* data, size_t size) {
+    char* buffer = (char*) data;
+    while (size > 0) {
+        ssize_t got = read(fd, buffer, size);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        buffer += got;
+        size -= got;
+    }
+    return true;
+}
+
+bool write_full(int fd, const void* data, size_t size) {
+    const char* buffer = (const char*) data;
+    while (size > 0) {
+        ssize_t written = write(fd, buffer, size);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        buffer += written;
+        size -= written;
+    }
+    return true;
+}
+
+/**
+ * Reads one request batch. Fails as soon as a pattern longer than
+ * max_length is announced, before its bytes are read.
+ */
+bool read_batch(int fd, vector <string>& patterns, size_t max_length) {
+    uint32_t count, length;
+    if (!read_full(fd, &count, sizeof(count)) || count > MAX_BATCH_PATTERNS) return false;
+    patterns.resize(count);
+    for (auto& pattern : patterns) {
+        if (!read_full(fd, &length, sizeof(length))) return false;
+        if (length > max_length || length > MAX_PATTERN_LENGTH) {
+            cerr << "Rejecting pattern of length " << length << endl;
+            return false;
+        }
+        pattern.resize(length);
+        if (length > 0 && !read_full(fd, &pattern [0], length)) return false;
+    }
+    return true;
+}
+
+bool write_batch(int fd, const vector <string>& patterns) {
+    string buffer;
+    uint32_t count = patterns.size();
+    buffer.append((const char*) &count, sizeof(count));
+    for (auto& pattern : patterns) {
+        uint32_t length = pattern.size();
+        buffer.append((const char*) &length, sizeof(length));
+        buffer.append(pattern);
+    }
+    return write_full(fd, buffer.data(), buffer.size());
+}
+
+bool read_results(int fd, vector <vector <int> >& results) {
+    uint32_t count, n;
+    if (!read_full(fd, &count, sizeof(count))) return false;
+    results.resize(count);
+    for (auto& reads : results) {
+        if (!read_full(fd, &n, sizeof(n))) return false;
+        vector <uint32_t> ids(n);
+        if (n > 0 && !read_full(fd, ids.data(), n * sizeof(uint32_t))) return false;
+        reads.assign(ids.begin(), ids.end());
+    }
+    return true;
+}
+
+bool write_results(int fd, const vector <vector <int> >& results) {
+    vector <uint32_t> buffer;
+    buffer.push_back(results.size());
+    for (auto& reads : results) {
+        buffer.push_back(reads.size());
+        buffer.insert(buffer.end(), reads.begin(), reads.end());
+    }
+    return write_full(fd, buffer.data(), buffer.size() * sizeof(uint32_t));
+}
@@ -0,0 +1,32 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+ * Binary protocol of the query server, all integers are 32-bit unsigned
+ * in host byte order (client and server share a machine).
+ *
+ * Request batch:  count, then count times (length, length bytes of pattern)
+ * Response batch: count, then count times (n, n read ids)
+ *
+ * A client may send any number of batches before reading responses,
+ * responses come back in the order of the requests.
+ */
+
+// Limits protecting the server from malformed requests
+#define MAX_BATCH_PATTERNS (1 << 20)
+#define MAX_PATTERN_LENGTH (1 << 16)
+
+bool read_full(int, void*, size_t);
+bool write_full(int, const void*, size_t);
+bool read_batch(int, vector <string>&, size_t max_length = MAX_PATTERN_LENGTH);
+bool write_batch(int, const vector <string>&);
+bool read_results(int, vector <vector <int> >&);
+bool write_results(int, const vector <vector <int> >&);
+
+#endif //PROTOCOL_H
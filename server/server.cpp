@@ -0,0 +1,211 @@
+#include "../sr-index.hpp"
+#include "protocol.h"
+#include <condition_variable>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Patterns of a batch are split into tasks of this many for the workers
+#ifndef TASK_PATTERNS
+#define TASK_PATTERNS 256
+#endif
+
+// Answered batches a connection may hold before it stops reading requests
+#ifndef OUTBOX_BATCHES
+#define OUTBOX_BATCHES 4
+#endif
+
+/**
+ * Fixed set of threads running submitted tasks in FIFO order.
+ */
+class WorkerPool {
+    vector <thread> workers;
+    queue <function <void()> > tasks;
+    mutex lock;
+    condition_variable available;
+    void work() {
+        while (true) {
+            function <void()> task;
+            {
+                unique_lock <mutex> guard(lock);
+                available.wait(guard, [this] {return !tasks.empty();});
+                task = move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+    public:
+        WorkerPool(int count) {
+            for (int i = 0; i < count; i++) workers.push_back(thread(&WorkerPool::work, this));
+        }
+        void submit(function <void()> task) {
+            {
+                lock_guard <mutex> guard(lock);
+                tasks.push(move(task));
+            }
+            available.notify_one();
+        }
+};
+
+/**
+ * Answers one batch, split into tasks run on the pool, and waits for all of them.
+ */
+vector <vector <int> > answer_batch(SR_index& index, WorkerPool& pool, const vector <string>& patterns) {
+    vector <vector <int> > results(patterns.size());
+    mutex lock;
+    condition_variable done;
+    size_t pending = 0;
+    for (size_t first = 0; first < patterns.size(); first += TASK_PATTERNS) {
+        size_t last = min(patterns.size(), first + TASK_PATTERNS);
+        {
+            lock_guard <mutex> guard(lock);
+            pending ++;
+        }
+        pool.submit([&, first, last] {
+            vector <string> task_patterns(patterns.begin() + first, patterns.begin() + last);
+            vector <vector <int> > task_results = index.find_reads_batch(task_patterns);
+            for (size_t i = first; i < last; i++) {
+                results [i] = move(task_results [i - first]);
+            }
+            lock_guard <mutex> guard(lock);
+            pending --;
+            if (pending == 0) done.notify_one();
+        });
+    }
+    unique_lock <mutex> guard(lock);
+    done.wait(guard, [&pending] {return pending == 0;});
+    return results;
+}
+
+/**
+ * Answered batches of one connection waiting to be written, in request order.
+ * Holds at most OUTBOX_BATCHES of them, so a client that does not read
+ * its responses only stalls its own connection.
+ */
+struct Outbox {
+    queue <vector <vector <int> > > results;
+    bool closed = false, broken = false;
+    mutex lock;
+    condition_variable ready;
+};
+
+/**
+ * Writes answered batches until the reader closes the outbox and it is drained.
+ */
+void write_responses(int client, Outbox& outbox) {
+    while (true) {
+        vector <vector <int> > results;
+        {
+            unique_lock <mutex> guard(outbox.lock);
+            outbox.ready.wait(guard, [&outbox] {return !outbox.results.empty() || outbox.closed;});
+            if (outbox.results.empty()) return;
+            results = move(outbox.results.front());
+            outbox.results.pop();
+        }
+        outbox.ready.notify_all();
+        if (!write_results(client, results)) {
+            // Client went away, wake the reader blocked on it
+            {
+                lock_guard <mutex> guard(outbox.lock);
+                outbox.broken = true;
+            }
+            outbox.ready.notify_all();
+            shutdown(client, SHUT_RDWR);
+            return;
+        }
+    }
+}
+
+/**
+ * Serves batches of one client until it disconnects or sends a malformed batch.
+ * Requests are read and answered here while a separate thread writes the
+ * responses, so neither side blocks on a full socket buffer of the other.
+ */
+void serve_client(int client, SR_index& index, WorkerPool& pool) {
+    Outbox outbox;
+    thread writer(write_responses, client, ref(outbox));
+    vector <string> patterns;
+    while (read_batch(client, patterns, index.get_k())) {
+        bool valid = true;
+        for (auto& pattern : patterns) {
+            if (pattern.find_first_not_of("ACGT") != string::npos) valid = false;
+        }
+        if (!valid) {
+            cerr << "Rejecting batch with pattern outside ACGT\n";
+            break;
+        }
+        vector <vector <int> > results = answer_batch(index, pool, patterns);
+        {
+            unique_lock <mutex> guard(outbox.lock);
+            outbox.ready.wait(guard, [&outbox] {return outbox.results.size() < OUTBOX_BATCHES || outbox.broken;});
+            if (outbox.broken) break;
+            outbox.results.push(move(results));
+        }
+        outbox.ready.notify_all();
+    }
+    {
+        lock_guard <mutex> guard(outbox.lock);
+        outbox.closed = true;
+    }
+    outbox.ready.notify_all();
+    writer.join();
+    close(client);
+}
+
+int main (const int argc, const char* argv[]) {
+    if (argc < 3) {
+        cerr << "Usage " << argv[0] << " <index_file> <socket_path> [workers] [cache_mb]\n";
+        exit(1);
+    }
+    int workers = argc > 3 ? stoi(argv[3]) : thread::hardware_concurrency();
+    long long cache_mb = argc > 4 ? stoll(argv[4]) : 0;
+
+    SR_index index(0);
+    ifstream index_in(argv[1], ifstream::binary);
+    if (!index_in) {
+        cerr << "Cannot open " << argv[1] << endl;
+        exit(1);
+    }
+    index.load(index_in);
+    index_in.close();
+    if (cache_mb > 0) index.enable_cache(cache_mb << 20);
+    cerr << "Index loaded, k = " << index.get_k() << endl;
+
+    // Clients going away mid-response must not kill the server
+    signal(SIGPIPE, SIG_IGN);
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(argv[2]) >= sizeof(address.sun_path)) {
+        cerr << "Socket path too long\n";
+        exit(1);
+    }
+    strcpy(address.sun_path, argv[2]);
+    unlink(argv[2]);
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0 || bind(listener, (struct sockaddr*) &address, sizeof(address)) < 0 || listen(listener, 128) < 0) {
+        perror("Listening failed");
+        exit(1);
+    }
+    cerr << "Listening on " << argv[2] << " with " << workers << " workers" << endl;
+
+    WorkerPool pool(max(workers, 1));
+    while (true) {
+        int client = accept(listener, nullptr, nullptr);
+        if (client < 0) {
+            if (errno != EINTR) perror("Accept failed");
+            continue;
+        }
+        thread(serve_client, client, ref(index), ref(pool)).detach();
+    }
+}
@@ -54,7 +54,9 @@ void SR_index::construct_superstring(const string& fasta_file) {
     vector <int_t> result_ints = g.euler_path();
     vector <int> result_counts = g.path_counts();
     vector <int> string_counts;
+    this -> graph_metrics = g.get_metrics();
     
+    metrics.start_stage("fm_index");
     cerr << "Construct FM-index\n";
     construct_im(this -> fm_index, decode(result_ints, this -> k, result_counts, string_counts), 1);
     
@@ -62,27 +64,44 @@ void SR_index::construct_superstring(const string& fasta_file) {
     cerr << fm_index.size() << ' ' << counts.size() << endl;
     cerr << "FM index size in mb: " << size_in_mega_bytes(fm_index) << endl;
     cerr << "counts vector size in mb: " << size_in_mega_bytes(counts) << endl;
+    metrics.set_count("superstring_length", fm_index.size() - 1);
+#ifdef RUN_LENGTH_FM
+    // A full pass over the BWT, timed separately from the FM index construction
+    metrics.start_stage("bwt_runs");
+    long long bwt_runs = 0;
+    for (fm_index_t::size_type i = 0; i < fm_index.size(); i++) {
+        if (i == 0 || fm_index.bwt [i] != fm_index.bwt [i - 1]) bwt_runs ++;
+    }
+    metrics.set_count("bwt_runs", bwt_runs);
+#endif
+    metrics.start_stage("valid_ends");
     bit_vector valid_ends(string_counts.size());
     for (auto i = 0; i < string_counts.size(); i++) {
         valid_ends [i] = (string_counts [i] > 1);
     }
     valid_end = rrr_vector<>(valid_ends);
     cerr << "Valid ends vector size in mb: " << size_in_mega_bytes(valid_end) << endl;
+    metrics.finish_stage();
 }
 
 void SR_index::construct(const string& fasta_file) {
+    if (cache) cache -> clear();
     construct_superstring(fasta_file);
+    metrics.start_stage("placements");
     cerr << "start processing intervals" << endl;
     
     ifstream file_in(fasta_file, ifstream::in);
     string seq;
     vector <long long> start_indices;
     vector <bool> starts, valid_positions;
-    vector <long long> set_bits;
-    long long current_offset = 0;
+    vector <long long> set_bits, placement_offsets;
+    long long current_offset = 0, reads = 0;
     int k = this -> k;
+    max_read_length = 0;
     while (file_in >> seq) {
         file_in >> seq;
+        reads ++;
+        max_read_length = max(max_read_length, (long long) seq.size());
         vector <pair <int, int> > positions;
         for (int i = 0; i <= (int) seq.size() - k; i++) {
             auto occs = locate(fm_index, seq.substr(i, k));
@@ -102,34 +121,41 @@ void SR_index::construct(const string& fasta_file) {
                 exit(1);
             }
         }
-        vector <bool> validinread(max_read_length + 1, false); 
+        // Each placement gets a slot of the read length + 1 in valid_in_read,
+        // the last position is never valid so every slot ends outside an interval
+        long long slot = seq.size() + 1;
+        vector <bool> validinread(slot, false); 
         sort (positions.begin(), positions.end());
         starts.push_back(true);
         start_indices.push_back(positions[0].first);
+        placement_offsets.push_back(current_offset);
         for (int i = positions [0].second; i < positions [0].second + k; i++) validinread [i] = true;
         for (int i = 1; i < positions.size(); i++) {
             if (start_indices.back() != positions [i].first) {
                 start_indices.push_back(positions [i].first);
                 starts.push_back(false);
                 bool last = false;
-                for (int j = 0; j <= max_read_length; j++) {
+                for (int j = 0; j < slot; j++) {
                     if (validinread [j] != last) set_bits.push_back(current_offset + j); 
                     last = validinread [j];
                     validinread [j] = false;
                 }
-                current_offset += max_read_length + 1;
+                current_offset += slot;
+                placement_offsets.push_back(current_offset);
             }
             for (int j = positions [i].second; j < positions [i].second + k; j++) validinread [j] = true;
         }
         bool last = false;
-        for (int j = 0; j <= max_read_length; j++) {
+        for (int j = 0; j < slot; j++) {
             if (validinread [j] != last) set_bits.push_back(current_offset + j);
             else valid_positions.push_back(false);
             last = validinread [j];
             validinread [j] = false;
         }
-        current_offset += max_read_length + 1;
+        current_offset += slot;
     }
+    // Closing offset, so that the slot of placement i is [select(i + 1), select(i + 2))
+    placement_offsets.push_back(current_offset);
 
     vector <long long> start_indices_permutation(start_indices.size());
     for (int i = 0; i < start_indices.size(); i++) {
@@ -139,6 +165,10 @@ void SR_index::construct(const string& fasta_file) {
     sort (start_indices_permutation.begin(), start_indices_permutation.end(), [&start_indices](int i1, int i2) {return start_indices [i1] < start_indices [i2];});
 
     file_in.close();
+    metrics.set_count("reads", reads);
+    metrics.set_count("placements", start_indices.size());
+    metrics.set_count("valid_in_read_ones", set_bits.size());
+    metrics.start_stage("succinct_structures");
     cerr << "start_indices number of elements: " << start_indices.size() << endl;
     this -> start_indices = vlc_vector<>(start_indices);
     cerr << "start_indices vlc: " << size_in_mega_bytes(this -> start_indices) << endl;
@@ -151,50 +181,214 @@ void SR_index::construct(const string& fasta_file) {
     cerr << "starts sd_vector: " << size_in_mega_bytes(this -> new_read_start) << endl;
     this -> valid_in_read = sd_vector<>(set_bits.begin(), set_bits.end());
     this -> valid_in_read_rank = sd_vector<>::rank_1_type(&(this -> valid_in_read));
+    this -> valid_in_read_select = sd_vector<>::select_1_type(&(this -> valid_in_read));
     cerr << "valid in read sd_vector: " << size_in_mega_bytes(this -> valid_in_read) << endl;
+    this -> placement_offset = sd_vector<>(placement_offsets.begin(), placement_offsets.end());
+    this -> placement_offset_select = sd_vector<>::select_1_type(&(this -> placement_offset));
+    cerr << "placement offset sd_vector: " << size_in_mega_bytes(this -> placement_offset) << endl;
     file_in.close();
+    metrics.finish_stage();
+
+    metrics.set_bytes("fm_index", size_in_bytes(fm_index));
+    metrics.set_bytes("counts", size_in_bytes(counts));
+    metrics.set_bytes("valid_end", size_in_bytes(valid_end));
+    metrics.set_bytes("start_indices", size_in_bytes(this -> start_indices));
+    metrics.set_bytes("start_indices_permutation", size_in_bytes(this -> start_indices_permutation));
+    metrics.set_bytes("new_read_start", size_in_bytes(new_read_start) + size_in_bytes(read_start_rank));
+    metrics.set_bytes("valid_in_read", size_in_bytes(valid_in_read) + size_in_bytes(valid_in_read_rank) + size_in_bytes(valid_in_read_select));
+    metrics.set_bytes("placement_offset", size_in_bytes(placement_offset) + size_in_bytes(placement_offset_select));
+    metrics.set_bytes("total", size_in_bytes(*this));
 }
 
-vector<int> SR_index::find_reads(const string& query, bool debug) {
-    if (query.size() > k) {
-        cerr << "Query longer than k\n";
-        exit(1);
-    }
-    long long the_position = -1;
-    vector <int> result;
-    for (auto pos : locate(fm_index, query)) {
-        if (counts [pos + query.size() - 1] > 1) {
-            the_position = pos;
-            break;
-        }
-    }
+fm_index_t::size_type SR_index::serialize(ostream& out, structure_tree_node* v, string name) const {
+    structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+    fm_index_t::size_type written_bytes = 0;
+    written_bytes += write_member(k, out, child, "k");
+    written_bytes += write_member(max_read_length, out, child, "max_read_length");
+    written_bytes += fm_index.serialize(out, child, "fm_index");
+    written_bytes += counts.serialize(out, child, "counts");
+    written_bytes += valid_end.serialize(out, child, "valid_end");
+    written_bytes += start_indices.serialize(out, child, "start_indices");
+    written_bytes += start_indices_permutation.serialize(out, child, "start_indices_permutation");
+    written_bytes += new_read_start.serialize(out, child, "new_read_start");
+    written_bytes += read_start_rank.serialize(out, child, "read_start_rank");
+    written_bytes += valid_in_read.serialize(out, child, "valid_in_read");
+    written_bytes += valid_in_read_rank.serialize(out, child, "valid_in_read_rank");
+    written_bytes += valid_in_read_select.serialize(out, child, "valid_in_read_select");
+    written_bytes += placement_offset.serialize(out, child, "placement_offset");
+    written_bytes += placement_offset_select.serialize(out, child, "placement_offset_select");
+    structure_tree::add_size(child, written_bytes);
+    return written_bytes;
+}
 
-    if (the_position == -1) {
-        return result;
+/**
+ * Loads an index written by serialize. Build metrics are not persisted.
+ */
+void SR_index::load(istream& in) {
+    read_member(k, in);
+    read_member(max_read_length, in);
+    fm_index.load(in);
+    counts.load(in);
+    valid_end.load(in);
+    start_indices.load(in);
+    start_indices_permutation.load(in);
+    new_read_start.load(in);
+    read_start_rank.load(in, &new_read_start);
+    valid_in_read.load(in);
+    valid_in_read_rank.load(in, &valid_in_read);
+    valid_in_read_select.load(in, &valid_in_read);
+    placement_offset.load(in);
+    placement_offset_select.load(in, &placement_offset);
+    if (cache) cache -> clear();
+}
+
+/**
+ * Caches results of up to max_bytes in front of find_reads, find_reads_approx
+ * and find_reads_batch. Cached results are dropped on construct and load.
+ */
+void SR_index::enable_cache(size_t max_bytes) {
+    cache.reset(new QueryCache(max_bytes));
+}
+
+void SR_index::disable_cache() {
+    cache.reset();
+}
+
+const QueryCache* SR_index::get_cache() {
+    return cache.get();
+}
+
+void SR_index::write_cache_stats(ostream& out) {
+    if (cache) cache -> write_stats(out);
+    else out << "{}";
+    out << endl;
+}
+
+/**
+ * Writes build metrics of the graph and of the index as one JSON object.
+ */
+void SR_index::write_metrics(ostream& out) {
+    out << "{\"graph\": ";
+    graph_metrics.write_json(out);
+    out << ", \"index\": ";
+    metrics.write_json(out);
+    out << "}" << endl;
+}
+
+/**
+ * Writes build metrics of the graph and of the index as CSV rows under label.
+ */
+void SR_index::write_metrics_csv(ostream& out, const string& label) {
+    graph_metrics.write_csv(out, label, "graph");
+    metrics.write_csv(out, label, "index");
+}
+
+/**
+ * Writes the memory breakdown of all index structures in sdsl JSON format.
+ */
+void SR_index::write_structure(ostream& out) {
+    sdsl::write_structure<JSON_FORMAT>(*this, out);
+}
+
+/**
+ * Returns the first position in the SA interval [lb, rb] whose occurrence
+ * of a string of given length ends at a valid end, or -1 if there is none.
+ */
+long long SR_index::valid_position(fm_index_t::size_type lb, fm_index_t::size_type rb, long long length, QueryStats* stats) {
+    for (auto i = lb; i <= rb; i++) {
+        long long pos = fm_index [i];
+        COUNT_STAT(stats, occurrences_examined, 1);
+        if (counts [pos + length - 1] > 1) {
+            return pos;
+        }
+        COUNT_STAT(stats, rejected_by_counts, 1);
     }
+    return -1;
+}
 
+/**
+ * Adds to results all reads containing the string of given length
+ * placed at the_position of the superstring.
+ */
+void SR_index::collect_reads(long long the_position, long long length, set <int>& results, bool debug, QueryStats* stats) {
     if (debug) cerr << "THE position : " << the_position << endl;
 
     long long lower = -1, upper = start_indices_permutation.size();
     while (upper - lower > 1) {
         int middle = (upper + lower) / 2;
-        if (start_indices[start_indices_permutation[middle]]  < the_position + query.size() - 1) lower = middle;
+        COUNT_STAT(stats, binary_search_probes, 1);
+        if ((long long) start_indices[start_indices_permutation[middle]]  < the_position + length - 1) lower = middle;
         else upper = middle;
     }
     long long current = upper;
     if (debug) cerr << "First possible index: " << current << ' ' << start_indices [start_indices_permutation [current]] << ' ' << (long long) start_indices [start_indices_permutation [current] ] - max_read_length << endl << "Zaciatok ";
-    set <int> results;
-    while (current < start_indices_permutation.size() && (long long) start_indices[start_indices_permutation[current]] - max_read_length <= the_position) {
+    while (current < (long long) start_indices_permutation.size() && (long long) start_indices[start_indices_permutation[current]] - max_read_length <= the_position) {
         long long curstart = start_indices [start_indices_permutation[current]] - max_read_length;
-        long long valid_in_read_offset = (max_read_length + 1) * start_indices_permutation [current];
+        long long valid_in_read_offset = placement_offset_select(start_indices_permutation [current] + 1);
+        long long slot_end = placement_offset_select(start_indices_permutation [current] + 2);
         if (debug) cerr << start_indices_permutation[current];
-        if ((valid_in_read_rank(valid_in_read_offset + the_position - curstart + 1) % 2) == 1 && (valid_in_read_rank(valid_in_read_offset + the_position - curstart + query.size()) == valid_in_read_rank(valid_in_read_offset + the_position - curstart + 1))) {
-            results.insert(read_start_rank(start_indices_permutation [current] + 1));
+        COUNT_STAT(stats, candidates_scanned, 1);
+        // Reads shorter than max_read_length may end before the query does
+        if (valid_in_read_offset + the_position - curstart + length < slot_end) {
+            COUNT_STAT(stats, rank_calls, 1);
+            if ((valid_in_read_rank(valid_in_read_offset + the_position - curstart + 1) % 2) == 1) {
+                COUNT_STAT(stats, rank_calls, 2);
+                if (valid_in_read_rank(valid_in_read_offset + the_position - curstart + length) == valid_in_read_rank(valid_in_read_offset + the_position - curstart + 1)) {
+                    COUNT_STAT(stats, rank_calls, 1);
+                    results.insert(read_start_rank(start_indices_permutation [current] + 1));
+                }
+            }
         }
 
         current ++;
     }
     if(debug) cerr << endl;
+}
+
+/**
+ * Cache keys of exact and approximate searches. The leading mode byte
+ * keeps them apart whatever characters the query contains.
+ */
+inline string exact_cache_key(const string& query) {
+    return 'E' + query;
+}
+
+inline string approx_cache_key(const string& query, int max_mismatches) {
+    return string("A") + (char) max_mismatches + query;
+}
+
+vector<int> SR_index::find_reads(const string& query, bool debug, QueryStats* stats) {
+    if (query.size() > k) {
+        cerr << "Query longer than k\n";
+        exit(1);
+    }
+    // Debugging and counting runs want to see the work, not a cached result
+    bool use_cache = cache && !debug && stats == nullptr;
+    vector <int> result;
+    if (use_cache && cache -> lookup(exact_cache_key(query), result)) {
+        return result;
+    }
+    result = search_reads(query, debug, stats);
+    if (use_cache) {
+        cache -> insert(exact_cache_key(query), result);
+    }
+    return result;
+}
+
+vector<int> SR_index::search_reads(const string& query, bool debug, QueryStats* stats) {
+    vector <int> result;
+    fm_index_t::size_type lb, rb;
+    if (backward_search(fm_index, 0, fm_index.size() - 1, query.begin(), query.end(), lb, rb) == 0) {
+        return result;
+    }
+    long long the_position = valid_position(lb, rb, query.size(), stats);
+
+    if (the_position == -1) {
+        return result;
+    }
+
+    set <int> results;
+    collect_reads(the_position, query.size(), results, debug, stats);
 
     for (auto x : results) {
         result.push_back(x - 1);
@@ -203,6 +397,259 @@ vector<int> SR_index::find_reads(const string& query, bool debug) {
 
 }
 
+/**
+ * Hints the cache with the root level data word of the wavelet tree at
+ * position i. Only that word is reachable through sdsl's public interface:
+ * the rank_support_v block counters and the bits of deeper levels are
+ * not prefetched, so their misses are only overlapped by the interleaving.
+ * No-op for other wavelet trees.
+ */
+template<class t_wt>
+inline void prefetch_rank(const t_wt&, fm_index_t::size_type) {}
+
+inline void prefetch_rank(const wt_huff<>& wt, fm_index_t::size_type i) {
+    __builtin_prefetch(wt.bv.data() + (i >> 6));
+}
+
+/**
+ * Finds reads for a batch of queries. Backward searches of BATCH_WIDTH
+ * queries advance in lock-step: every step first prefetches the root level
+ * words of all of them and only then does the ranks, so the independent
+ * rank calls of different queries can overlap their cache misses.
+ */
+vector <vector <int> > SR_index::find_reads_batch(const vector <string>& queries) {
+    vector <vector <int> > result(queries.size());
+    for (unsigned int first = 0; first < queries.size(); first += BATCH_WIDTH) {
+        unsigned int width = min((unsigned int) BATCH_WIDTH, (unsigned int) queries.size() - first);
+        fm_index_t::size_type lb [BATCH_WIDTH], rb [BATCH_WIDTH];
+        unsigned int remaining [BATCH_WIDTH];
+        bool found [BATCH_WIDTH], cached [BATCH_WIDTH];
+        for (unsigned int j = 0; j < width; j++) {
+            if ((long long) queries [first + j].size() > k) {
+                cerr << "Query longer than k\n";
+                exit(1);
+            }
+            lb [j] = 0;
+            rb [j] = fm_index.size() - 1;
+            remaining [j] = queries [first + j].size();
+            cached [j] = cache && cache -> lookup(exact_cache_key(queries [first + j]), result [first + j]);
+            found [j] = !cached [j];
+        }
+
+        bool active = true;
+        while (active) {
+            active = false;
+            for (unsigned int j = 0; j < width; j++) {
+                if (found [j] && remaining [j] > 0) {
+                    prefetch_rank(fm_index.wavelet_tree, lb [j]);
+                    prefetch_rank(fm_index.wavelet_tree, rb [j] + 1);
+                }
+            }
+            for (unsigned int j = 0; j < width; j++) {
+                if (found [j] && remaining [j] > 0) {
+                    remaining [j] --;
+                    found [j] = (backward_search(fm_index, lb [j], rb [j], queries [first + j] [remaining [j]], lb [j], rb [j]) > 0);
+                    active = true;
+                }
+            }
+        }
+
+        for (unsigned int j = 0; j < width; j++) {
+            if (cached [j]) continue;
+            long long the_position = found [j] ? valid_position(lb [j], rb [j], queries [first + j].size(), nullptr) : -1;
+            if (the_position != -1) {
+                set <int> results;
+                collect_reads(the_position, queries [first + j].size(), results, false, nullptr);
+                for (auto x : results) {
+                    result [first + j].push_back(x - 1);
+                }
+            }
+            if (cache) {
+                cache -> insert(exact_cache_key(queries [first + j]), result [first + j]);
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * Backtracking backward search matching query[0, remaining) into the
+ * SA interval [lb, rb]. Branches are pruned when the lower bound on the
+ * mismatches needed for the rest of the query exceeds the ones left.
+ * Pushes the valid position of every matched string to positions.
+ */
+void SR_index::approx_search(const string& query, int remaining, int mismatches, fm_index_t::size_type lb, fm_index_t::size_type rb, const vector <int>& lower_bound, vector <long long>& positions) {
+    if (remaining == 0) {
+        long long pos = valid_position(lb, rb, query.size(), nullptr);
+        if (pos != -1) positions.push_back(pos);
+        return;
+    }
+    if (mismatches < lower_bound [remaining - 1]) return;
+
+    // Symbol 0 is the sentinel, never part of a match
+    for (fm_index_t::size_type c = 1; c < fm_index.sigma; c++) {
+        char base = fm_index.comp2char [c];
+        int cost = (base != query [remaining - 1]);
+        if (cost > mismatches) continue;
+        fm_index_t::size_type new_lb, new_rb;
+        if (backward_search(fm_index, lb, rb, base, new_lb, new_rb) == 0) continue;
+        approx_search(query, remaining - 1, mismatches - cost, new_lb, new_rb, lower_bound, positions);
+    }
+}
+
+/**
+ * Finds reads containing the query with at most max_mismatches substitutions.
+ */
+vector<int> SR_index::find_reads_approx(const string& query, int max_mismatches) {
+    if ((long long) query.size() > k) {
+        cerr << "Query longer than k\n";
+        exit(1);
+    }
+    string key = approx_cache_key(query, max_mismatches);
+    vector <int> result;
+    if (cache && cache -> lookup(key, result)) {
+        return result;
+    }
+
+    // lower_bound [i] is a lower bound on the mismatches in query[0, i]:
+    // every maximal piece which does not occur in the superstring needs one.
+    vector <int> lower_bound(query.size());
+    int pieces = 0;
+    unsigned int piece_start = 0;
+    for (unsigned int i = 0; i < query.size(); i++) {
+        fm_index_t::size_type lb, rb;
+        if (backward_search(fm_index, 0, fm_index.size() - 1, query.begin() + piece_start, query.begin() + i + 1, lb, rb) == 0) {
+            pieces ++;
+            piece_start = i + 1;
+        }
+        lower_bound [i] = pieces;
+    }
+
+    vector <long long> positions;
+    approx_search(query, query.size(), max_mismatches, 0, fm_index.size() - 1, lower_bound, positions);
+
+    set <int> results;
+    for (long long pos : positions) {
+        collect_reads(pos, query.size(), results, false, nullptr);
+    }
+
+    for (auto x : results) {
+        result.push_back(x - 1);
+    }
+    if (cache) {
+        cache -> insert(key, result);
+    }
+    return result;
+}
+
+/**
+ * Finds reads overlapping the superstring position, one placement at a time.
+ */
+vector <int> SR_index::find_reads_at(long long position) {
+    set <int> results;
+    collect_reads(position, 1, results, false, nullptr);
+    vector <int> result;
+    for (auto x : results) {
+        result.push_back(x - 1);
+    }
+    return result;
+}
+
+/**
+ * A read placement decoded once when the bulk sweep reaches it: its start
+ * in the superstring, the read it belongs to and its valid intervals
+ * (inclusive, relative to start).
+ */
+struct decoded_placement {
+    long long start;
+    int read;
+    vector <pair <long long, long long> > valid;
+};
+
+/**
+ * For each position of the sorted positions, finds all reads overlapping it.
+ * Positions are swept against the read placements sorted by start, so every
+ * placement is decoded (two rank calls and a select per valid interval)
+ * at most once per call, regardless of the number of positions it covers.
+ */
+vector <vector <int> > SR_index::find_reads_bulk(const vector <long long>& positions) {
+    vector <vector <int> > result(positions.size());
+    deque <decoded_placement> window;
+    long long next = 0, placements = start_indices_permutation.size();
+    long long total_ones = valid_in_read_rank(valid_in_read.size());
+    for (unsigned int i = 0; i < positions.size(); i++) {
+        long long position = positions [i];
+        if (i > 0 && position < positions [i - 1]) {
+            cerr << "Positions not sorted\n";
+            exit(1);
+        }
+
+        // Placements starting at or before the position enter the window
+        while (next < placements && (long long) start_indices [start_indices_permutation [next]] - max_read_length <= position) {
+            long long placement = start_indices_permutation [next];
+            decoded_placement decoded;
+            decoded.start = (long long) start_indices [placement] - max_read_length;
+            decoded.read = read_start_rank(placement + 1) - 1;
+            long long offset = placement_offset_select(placement + 1);
+            long long slot_end = placement_offset_select(placement + 2);
+            long long ones = valid_in_read_rank(offset);
+            while (ones + 2 <= total_ones) {
+                long long open = valid_in_read_select(ones + 1);
+                if (open >= slot_end) break;
+                long long close = valid_in_read_select(ones + 2);
+                decoded.valid.push_back(make_pair(open - offset, close - offset - 1));
+                ones += 2;
+            }
+            window.push_back(decoded);
+            next ++;
+        }
+
+        // Placements ending before the position leave it
+        while (!window.empty() && window.front().start + max_read_length < position) {
+            window.pop_front();
+        }
+
+        for (auto& decoded : window) {
+            long long relative = position - decoded.start;
+            for (auto& interval : decoded.valid) {
+                if (interval.first <= relative && relative <= interval.second) {
+                    result [i].push_back(decoded.read);
+                    break;
+                }
+            }
+        }
+        sort(result [i].begin(), result [i].end());
+        result [i].erase(unique(result [i].begin(), result [i].end()), result [i].end());
+    }
+    return result;
+}
+
+/**
+ * Finds reads overlapping each position of the superstring interval [from, to].
+ */
+vector <vector <int> > SR_index::find_reads_in_interval(long long from, long long to) {
+    vector <long long> positions;
+    for (long long position = from; position <= to; position++) {
+        positions.push_back(position);
+    }
+    return find_reads_bulk(positions);
+}
+
+long long SR_index::superstring_length() {
+    return fm_index.size() - 1;
+}
+
+long long SR_index::get_k() {
+    return k;
+}
+
+/**
+ * Returns the superstring between positions from and to, inclusive.
+ */
+string SR_index::superstring(long long from, long long to) {
+    return extract(fm_index, from, to);
+}
+
 void SR_index::print_superstring() {
     cout << "superstring: " << extract(fm_index, 0, fm_index.size() - 1) << endl;
 }
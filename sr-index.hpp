@@ -2,17 +2,61 @@
 #define SR_INDEX__
 
 #include <algorithm>
+#include <deque>
 #include "common.h"
 #include "graph.h"
+#include "metrics.h"
+#include "query-cache.hpp"
 #include <sdsl/suffix_arrays.hpp>
 #include <boost/filesystem.hpp>
 #include <fstream>
+#include <memory>
 #include <sys/resource.h>
 
+#ifndef BATCH_WIDTH
+#define BATCH_WIDTH 32
+#endif
+
+// Same SA and ISA sample rates as the default csa_wt<>, so that
+// the two backends differ only in how the BWT is stored
+#ifndef RL_SA_SAMPLE
+#define RL_SA_SAMPLE 32
+#endif
+
+#ifndef RL_ISA_SAMPLE
+#define RL_ISA_SAMPLE 64
+#endif
+
+// With -DRUN_LENGTH_FM the BWT is kept in a run-length wavelet tree, whose
+// size scales with the number of BWT runs rather than the superstring length.
+#ifdef RUN_LENGTH_FM
+typedef sdsl::csa_wt<sdsl::wt_rlmn<>, RL_SA_SAMPLE, RL_ISA_SAMPLE> fm_index_t;
+#else
+typedef sdsl::csa_wt<> fm_index_t;
+#endif
+
+/**
+ * Work done by a single find_reads call. Filled in only when
+ * compiled with -DQUERY_STATS, otherwise all counting compiles away.
+ */
+struct QueryStats {
+    long long occurrences_examined = 0;
+    long long rejected_by_counts = 0;
+    long long binary_search_probes = 0;
+    long long candidates_scanned = 0;
+    long long rank_calls = 0;
+};
+
+#ifdef QUERY_STATS
+#define COUNT_STAT(stats, counter, value) do { if (stats != nullptr) stats -> counter += (value); } while (0)
+#else
+#define COUNT_STAT(stats, counter, value) do { (void) (stats); } while (0)
+#endif
+
 class SR_index {
     private:
         long long k, max_read_length;
-        sdsl::csa_wt<> fm_index;
+        fm_index_t fm_index;
         sdsl::vlc_vector<> counts;
         sdsl::rrr_vector<> valid_end;
         sdsl::vlc_vector<> start_indices;
@@ -21,13 +65,39 @@ class SR_index {
         sdsl::sd_vector<>::rank_1_type read_start_rank;
         sdsl::sd_vector<> valid_in_read;
         sdsl::sd_vector<>::rank_1_type valid_in_read_rank;
+        sdsl::sd_vector<>::select_1_type valid_in_read_select;
+        sdsl::sd_vector<> placement_offset;
+        sdsl::sd_vector<>::select_1_type placement_offset_select;
+        Metrics metrics, graph_metrics;
+        unique_ptr <QueryCache> cache;
+        vector <int> search_reads(const string&, bool, QueryStats*);
+        long long valid_position(fm_index_t::size_type, fm_index_t::size_type, long long, QueryStats*);
+        void collect_reads(long long, long long, set <int>&, bool, QueryStats*);
+        void approx_search(const string&, int, int, fm_index_t::size_type, fm_index_t::size_type, const vector <int>&, vector <long long>&);
 
     public:
         void construct(const string&);
         void construct_superstring(const string&);
-        SR_index(long long kk, long long max_read): k(kk), max_read_length(max_read){}
-        vector <int> find_reads(const string&, bool);
+        SR_index(long long kk): k(kk), max_read_length(0){}
+        vector <int> find_reads(const string&, bool, QueryStats* stats = nullptr);
+        vector <int> find_reads_approx(const string&, int);
+        vector <vector <int> > find_reads_batch(const vector <string>&);
+        vector <int> find_reads_at(long long);
+        vector <vector <int> > find_reads_bulk(const vector <long long>&);
+        vector <vector <int> > find_reads_in_interval(long long, long long);
+        long long superstring_length();
+        string superstring(long long, long long);
+        long long get_k();
         void print_superstring();
+        fm_index_t::size_type serialize(ostream&, sdsl::structure_tree_node* v = nullptr, string name = "") const;
+        void write_metrics(ostream&);
+        void write_metrics_csv(ostream&, const string&);
+        void write_structure(ostream&);
+        void load(istream&);
+        void enable_cache(size_t);
+        void disable_cache();
+        void write_cache_stats(ostream&);
+        const QueryCache* get_cache();
 };
 
 #endif //SR_INDEX__